@@ -0,0 +1,28 @@
+/*!
+ * @file allocs.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#include "allocs.h"
+
+#ifdef APPEND_COUNT_ALLOCS
+#include <cstdlib>
+#include <new>
+
+unsigned long ALLOC_COUNT = 0;
+
+void *operator new(std::size_t size) {
+  ++ALLOC_COUNT;
+  void *p = std::malloc(size ? size : 1);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
+#endif
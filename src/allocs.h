@@ -0,0 +1,13 @@
+/*!
+ * @file allocs.h
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ *
+ * Build with -DAPPEND_COUNT_ALLOCS to count every operator new. The
+ * engine then aborts if a tick of play, reset or drawing allocates.
+ */
+#pragma once
+
+#ifdef APPEND_COUNT_ALLOCS
+extern unsigned long ALLOC_COUNT;
+#endif
@@ -5,8 +5,13 @@
  */
 #include <iostream>
 #include <fstream>
-#include <string>
+#include <cstdlib>
+#include <cstring>
 #include "engine.h"
+#include "allocs.h"
+#include "profile.h"
+#include "spectator.h"
+#include "telemetry.h"
 
 Engine ENGINE;
 
@@ -43,13 +48,19 @@ void Entity::update(void) {
     case EntityID::GEM:
       if (x == ENGINE.player.x && y == ENGINE.player.y) {
         --ENGINE.gems;
+        ++TELEMETRY.attempt.gems;
         active = false;
+        ENGINE.dirty = true;
         return;
       }
       break;
     case EntityID::EXIT:
-      flag = ENGINE.gems == 0;
+      if (flag != (ENGINE.gems == 0)) {
+        flag = ENGINE.gems == 0;
+        ENGINE.dirty = true;
+      }
       if (flag && x == ENGINE.player.x && y == ENGINE.player.y) {
+        TELEMETRY.end(Outcome::COMPLETE, ENGINE.t);
         ++ENGINE.level_index;
         ENGINE.levelReset();
         return;
@@ -59,6 +70,7 @@ void Entity::update(void) {
       if (x == ENGINE.player.x && y == ENGINE.player.y) {
         ++ENGINE.keys;
         active = false;
+        ENGINE.dirty = true;
         return;
       }
       break;
@@ -69,12 +81,16 @@ void Entity::update(void) {
           flag = 1;
           ++y;
           --ENGINE.keys;
+          ++TELEMETRY.attempt.keys;
+          ENGINE.dirty = true;
       }
       break;
   }
 
   // Update position
   Tile *tile;
+  unsigned prev_x = x;
+  unsigned prev_y = y;
   switch (step) {
     case Step::NONE:
     default: break;
@@ -115,9 +131,13 @@ void Entity::update(void) {
       break;
   }
   step = Step::NONE;
+  if (x != prev_x || y != prev_y) {
+    ENGINE.dirty = true;
+  }
 }
 
 void Player::update(void) {
+  PROFILE_SCOPE("Player::update");
   // Apply gravity
   Tile &bel = ENGINE.current_level->get(x, y + 1);
   if (!bel.isSolid() && (bel.id != TileID::LADDER ||
@@ -141,238 +161,159 @@ void Player::update(void) {
     Tile &tile = ENGINE.current_level->get(prev_x, prev_y);
     tile.flag = char(tile.id); // *tosses type-safe enum out the window*
     tile.id = TileID::PLAYER_WALL; 
+    ++TELEMETRY.attempt.walls;
+    ENGINE.dirty = true;
   }
 }
 
-void Entity::draw(void) {
-  if (!active) return;
-  char c;
-  TCODColor fg = TCODColor::white;
-  TCODColor bg = TCODColor::black;
-  switch (id) {
-    case EntityID::NONE: return;
-    case EntityID::PLAYER:
-      c = '@';
-      fg = TCODColor::orange;
-      break;
-    case EntityID::GEM:
-      c = '*';
-      fg = TCODColor::cyan;
-      break;
-    case EntityID::EXIT:
-      c = 'O';
-      if (flag) {
-        fg = TCODColor::green;
-        bg = TCODColor::darkerGreen;
-      }
-      else {
-        fg = TCODColor::darkerGreen;
-      }
-      break;
-    case EntityID::KEY:
-      c = 'k';
-      fg = TCODColor::lightYellow;
-      break;
-    case EntityID::LOCK:
-      c = '#';
-      fg = TCODColor::black;
-      if (flag) {
-        bg = TCODColor::grey;
-      }
-      else {
-        bg = TCODColor::darkestGrey;
-      }
-      break;
-    default:
-      c = '?';
-      break;
-  }
-
-  // Because the camera view wraps around the edges of the level,
-  // it may be necessary to draw entities multiple times, offset
-  // by multiples of the level's width and height.
-  unsigned i, j;
-  for (unsigned ky = 0; true; ++ky) {
-    j = y + VIEW_Y - ENGINE.cam_y + ky * ENGINE.current_level->height;
-    if (j >= VIEW_Y + VIEW_H || j < VIEW_Y) break;
-
-    for (unsigned kx = 0; true; ++kx) {
-      i = x + VIEW_X - ENGINE.cam_x + kx * ENGINE.current_level->width;
-      if (i >= VIEW_X + VIEW_W || i < VIEW_X) break;
-      TCODConsole::root->putCharEx(i, j, c, fg, bg);
-
-      // Draw wrapped columns
-      if (kx > 0) {
-        i = x + VIEW_X - ENGINE.cam_x - kx * ENGINE.current_level->width;
-        if (i >= VIEW_X + VIEW_W || i < VIEW_X) continue;
-        TCODConsole::root->putCharEx(i, j, c, fg, bg);
-      }
-    }
-
-    // Draw wrapped rows
-    if (ky > 0) {
-      j = y + VIEW_Y - ENGINE.cam_y - ky * ENGINE.current_level->height;
-      if (j >= VIEW_Y + VIEW_H || j < VIEW_Y) continue;
-
-      for (unsigned kx = 0; true; ++kx) {
-        i = x + VIEW_X - ENGINE.cam_x + kx * ENGINE.current_level->width;
-        if (i >= VIEW_X + VIEW_W || i < VIEW_X) break;
-
-        TCODConsole::root->putCharEx(i, j, c, fg, bg);
-
-        // Draw wrapped columns
-        if (kx > 0) {
-          i = x + VIEW_X - ENGINE.cam_x - kx * ENGINE.current_level->width;
-          if (i >= VIEW_X + VIEW_W || i < VIEW_X) continue;
-          TCODConsole::root->putCharEx(i, j, c, fg, bg);
-        }
-      }
+void Entity::draw(Framebuffer &fb) {
+  if (!active || id == EntityID::NONE) return;
+  PROFILE_SCOPE("Entity::draw");
+  const Glyph &glyph = ENTITY_GLYPHS[unsigned(id)][flag ? 1 : 0];
+
+  // Because the camera view wraps around the edges of the level, the
+  // entity shows up every width columns and every height rows from its
+  // first on-screen position.
+  unsigned w = ENGINE.current_level->width;
+  unsigned h = ENGINE.current_level->height;
+  unsigned i0 = (x % w + w - ENGINE.cam_x % w) % w;
+  unsigned j0 = (y % h + h - ENGINE.cam_y % h) % h;
+  for (unsigned j = j0; j < VIEW_H; j += h) {
+    for (unsigned i = i0; i < VIEW_W; i += w) {
+      fb.cells[i + VIEW_W * j] = glyph;
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Level
-Level::Level(unsigned width, unsigned height) {
+Level::Level(void) {
+  tiles = nullptr;
+  initial = nullptr;
+  width = 0;
+  height = 0;
+  size = 0;
+  capacity = 0;
+}
+
+Level::Level(unsigned width, unsigned height) : Level() {
   this->width = width;
   this->height = height;
   size = width * height;
-  tiles = new Tile[size];
+  reserve(size);
   for (unsigned i = 0; i < size; ++i) {
-    tiles[i].id = TileID::NONE;
+    initial[i].id = TileID::NONE;
+    initial[i].flag = 0;
   }
+  reset();
+}
+
+Level::Level(const char *fname) : Level() {
+  load(fname);
+}
+
+Level::~Level(void) {
+  delete [] tiles;
+  delete [] initial;
 }
 
-Level::Level(const char *fname) {
+bool Level::load(const char *fname) {
   std::ifstream fin(fname);
-  if (fin.good()) {
-    width = 1; height = 1;
-    unsigned w, h;
-    fin >> w >> h;
-    for (unsigned i = 0; i < w; ++i) width *= 2;
-    for (unsigned i = 0; i < h; ++i) height *= 2;
-    size = width * height;
-    tiles = new Tile[size];
-    fin.ignore(256, '\n');
-
-    std::string line;
-    for (unsigned j = 0; j < height; ++j) {
-      std::getline(fin, line);
-      for (unsigned i = 0; i < width; ++i) {
-        TileID id;
-        if (i >= line.length()) {
-          id = TileID::NONE;
-        }
-        else {
-          switch (line[i]) {
-            // Tiles
-            default:
-            case ' ': id = TileID::NONE; break;
-            case '#': id = TileID::WALL; break;
-            case 'H': id = TileID::LADDER; break;
-            case 'o': id = TileID::PILLOW; break;
-            case 'x': id = TileID::SPIKE; break;
-            // Entities
-            case '@':
-              id = TileID::NONE;
-              ENGINE.player.init_x = i;
-              ENGINE.player.init_y = j;
-              break;
-            case '*': {
-              id = TileID::NONE;
-              Entity &ent = ENGINE.entities[ENGINE.entity_count];
-              ent.id = EntityID::GEM;
-              ent.active = true;
-              ent.init_x = i;
-              ent.init_y = j;
-              ++ENGINE.entity_count;
-              ++ENGINE.gems;
-            } break;
-            case 'O': {
-              id = TileID::NONE;
-              Entity &ent = ENGINE.entities[ENGINE.entity_count];
-              ent.id = EntityID::EXIT;
-              ent.active = true;
-              ent.init_x = i;
-              ent.init_y = j;
-              ++ENGINE.entity_count;
-            } break;
-            case 'k': {
-              id = TileID::NONE;
-              Entity &ent = ENGINE.entities[ENGINE.entity_count];
-              ent.id = EntityID::KEY;
-              ent.active = true;
-              ent.init_x = i;
-              ent.init_y = j;
-              ++ENGINE.entity_count;
-            } break;
-            case 'L': {
-              id = TileID::NONE;
-              Entity &ent = ENGINE.entities[ENGINE.entity_count];
-              ent.id = EntityID::LOCK;
-              ent.active = true;
-              ent.init_x = i;
-              ent.init_y = j;
-              ++ENGINE.entity_count;
-            } break;
-          }
-        }
-        tiles[i + width * j].id = id;
-      }
-    }
-    fin.close();
-  }
-  else {
+  if (!fin.good()) {
     std::cerr << "Error loading level from " << fname << std::endl;
+    return false;
   }
 
-}
-
-Level::~Level(void) {
   for (auto &i: ENGINE.entities) {
     i.active = false;
   }
-  delete [] tiles;
+  ENGINE.entity_count = 0;
+
+  width = 1; height = 1;
+  unsigned w, h;
+  fin >> w >> h;
+  for (unsigned i = 0; i < w; ++i) width *= 2;
+  for (unsigned i = 0; i < h; ++i) height *= 2;
+  size = width * height;
+  reserve(size);
+  fin.ignore(256, '\n');
+
+  for (unsigned j = 0; j < height; ++j) {
+    bool eol = false; // Rows may be shorter than the level is wide
+    for (unsigned i = 0; i < width; ++i) {
+      TileID id = TileID::NONE;
+      int c = eol ? '\n' : fin.get();
+      eol = c == '\n' || c == EOF;
+      switch (c) {
+        // Tiles
+        default:
+        case ' ': id = TileID::NONE; break;
+        case '#': id = TileID::WALL; break;
+        case 'H': id = TileID::LADDER; break;
+        case 'o': id = TileID::PILLOW; break;
+        case 'x': id = TileID::SPIKE; break;
+        // Entities
+        case '@':
+          ENGINE.player.init_x = i;
+          ENGINE.player.init_y = j;
+          break;
+        case '*': addEntity(EntityID::GEM, i, j); break;
+        case 'O': addEntity(EntityID::EXIT, i, j); break;
+        case 'k': addEntity(EntityID::KEY, i, j); break;
+        case 'L': addEntity(EntityID::LOCK, i, j); break;
+      }
+      initial[i + width * j].id = id;
+      initial[i + width * j].flag = 0;
+    }
+    if (!eol) fin.ignore(256, '\n');
+  }
+  fin.close();
+  return true;
 }
 
-void Level::draw(void) {
-  unsigned xx, yy;
-  for (unsigned j = VIEW_Y; j < VIEW_Y + VIEW_H; ++j) {
-    yy = (j + ENGINE.cam_y - VIEW_Y);
-    for (unsigned i = VIEW_X; i < VIEW_X + VIEW_W; ++i) {
-      xx = (i + ENGINE.cam_x - VIEW_X);
+void Level::addEntity(EntityID id, unsigned x, unsigned y) {
+  if (ENGINE.entity_count == ENTITY_MAX) return;
+  Entity &ent = ENGINE.entities[ENGINE.entity_count];
+  ent.id = id;
+  ent.active = true;
+  ent.init_x = x;
+  ent.init_y = y;
+  ++ENGINE.entity_count;
+}
 
-      char c = '\0';
-      TCODColor fg = TCODColor::white;
-      TCODColor bg = TCODColor::black;
+void Level::reset(void) {
+  std::memcpy(tiles, initial, size * sizeof(Tile));
+  ENGINE.dirty = true;
+}
 
-      Tile &tile = get(xx, yy);
-      switch (tile.id) {
-        case TileID::NONE: c = ' '; break;
-        case TileID::WALL:
-          c = '#';
-          break;
-        case TileID::PLAYER_WALL:
-          c = '#';
-          fg = TCODColor::lighterOrange;
-          break;
-        case TileID::LADDER:
-          c = 'H';
-          fg = TCODColor::yellow;
-          break;
-        case TileID::PILLOW:
-          c = 'o';
-          fg = TCODColor::pink;
-          break;
-        case TileID::SPIKE:
-          c = 'x';
-          fg = TCODColor::red;
-          break;
-        default: c = '?';
+void Level::reserve(unsigned size) {
+  // Grow only; smaller levels reuse what's already there.
+  if (size <= capacity) return;
+  delete [] tiles;
+  delete [] initial;
+  capacity = size;
+  tiles = new Tile[capacity];
+  initial = new Tile[capacity];
+}
+
+void Level::draw(Framebuffer &fb) {
+  PROFILE_SCOPE("Level::draw");
+  unsigned x0 = ENGINE.cam_x % width;
+  unsigned yy = ENGINE.cam_y % height;
+  for (unsigned j = 0; j < VIEW_H; ++j) {
+    // Copy the row in runs that stop at the level's right edge.
+    const Tile *row = tiles + width * yy;
+    Glyph *out = fb.cells + VIEW_W * j;
+    unsigned xx = x0;
+    for (unsigned i = 0; i < VIEW_W; xx = 0) {
+      unsigned n = width - xx;
+      if (n > VIEW_W - i) n = VIEW_W - i;
+      for (unsigned k = 0; k < n; ++k) {
+        out[i + k] = TILE_GLYPHS[unsigned(row[xx + k].id)];
       }
-      if (c != '\0')
-        TCODConsole::root->putCharEx(i, j, c, fg, bg);
+      i += n;
     }
+    if (++yy == height) yy = 0;
   }
 }
 
@@ -380,6 +321,7 @@ void Level::set(unsigned x, unsigned y, TileID id) {
   x %= width;
   y %= height;
   tiles[x + width * y].id = id;
+  ENGINE.dirty = true;
 }
 
 Tile &Level::get(unsigned x, unsigned y) {
@@ -388,6 +330,109 @@ Tile &Level::get(unsigned x, unsigned y) {
   return tiles[x + width * y];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Framebuffer
+void Framebuffer::blit(TCODConsole *con, unsigned x, unsigned y,
+                       Framebuffer &shown) {
+  // Only cells that differ from what's already on the console are put.
+  PROFILE_SCOPE("Framebuffer::blit");
+  const Glyph *cell = cells;
+  Glyph *old = shown.cells;
+  for (unsigned j = 0; j < VIEW_H; ++j) {
+    for (unsigned i = 0; i < VIEW_W; ++i, ++cell, ++old) {
+      if (cell->c == old->c && cell->fg == old->fg && cell->bg == old->bg) {
+        continue;
+      }
+      con->putCharEx(x + i, y + j, cell->c, *cell->fg, *cell->bg);
+      *old = *cell;
+    }
+  }
+}
+
+void Framebuffer::invalidate(void) {
+  for (auto &cell: cells) {
+    cell.c = '\0';
+    cell.fg = nullptr;
+    cell.bg = nullptr;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Input
+InputQueue::InputQueue(void) {
+  head = 0;
+  count = 0;
+}
+
+void InputQueue::poll(void) {
+  TCOD_key_t key;
+  while ((key = TCODConsole::checkForKeypress(TCOD_KEY_PRESSED)).vk !=
+         TCODK_NONE) {
+    push(key, TCODSystem::getElapsedMilli());
+  }
+}
+
+void InputQueue::push(const TCOD_key_t &key, unsigned long time) {
+  if (count) { // Coalesce key repeat into the event still waiting
+    InputEvent &back = events[(head + count - 1) % INPUT_MAX];
+    if (back.key.vk == key.vk && back.key.c == key.c &&
+        time - back.time < INPUT_COALESCE) {
+      back.time = time;
+      return;
+    }
+  }
+  if (count == INPUT_MAX) { // Full; the oldest keypress loses
+    head = (head + 1) % INPUT_MAX;
+    --count;
+  }
+  InputEvent &event = events[(head + count) % INPUT_MAX];
+  event.key = key;
+  event.time = time;
+  ++count;
+}
+
+bool InputQueue::pop(InputEvent &event) {
+  if (!count) return false;
+  event = events[head];
+  head = (head + 1) % INPUT_MAX;
+  --count;
+  return true;
+}
+
+InputLatency::InputLatency(void) {
+  waiting = false;
+  last = 0;
+  min = 0;
+  max = 0;
+  total = 0;
+  samples = 0;
+}
+
+void InputLatency::start(unsigned long time) {
+  if (waiting) return; // Measure from the oldest input not yet shown
+  waiting = true;
+  pending = time;
+}
+
+void InputLatency::stop(unsigned long time) {
+  if (!waiting) return;
+  waiting = false;
+  last = time - pending;
+  if (!samples || last < min) min = last;
+  if (last > max) max = last;
+  total += last;
+  ++samples;
+}
+
+void InputLatency::report(void) {
+  if (!samples) return;
+  std::cerr << "input latency (ms): last = " << last
+            << "; min = " << min
+            << "; mean = " << total / samples
+            << "; max = " << max
+            << "; samples = " << samples << ";" << std::endl;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Engine
 Engine::Engine(void) {
@@ -401,6 +446,8 @@ void Engine::init(void) {
     std::sprintf(levelfname[i], "res/%d.dat", i);
   }
   level_index = 0;
+  loaded_index = LEVEL_MAX;
+  drawn = EngineState::QUIT; // Anything but INTRO, to paint the first frame
   std::ifstream fin("res/append.dat");
   if (!fin) {
     save();
@@ -413,20 +460,42 @@ void Engine::init(void) {
 void Engine::run(void) {
   TCODConsole::initRoot(WIN_W, WIN_H, ":: INCONVENIENCE-JAM ::", false);
   TCODConsole::setKeyboardRepeat(300, 50);
+  TCODSystem::setFps(FPS);
+  renderScreens();
 
   while (!(quit || TCODConsole::isWindowClosed())) {
+#ifdef APPEND_COUNT_ALLOCS
+    unsigned long allocs = ALLOC_COUNT;
+    unsigned loaded = loaded_index;
+#endif
     update();
     draw();
+#ifdef APPEND_COUNT_ALLOCS
+    // Entering a level may grow the arena; anything else in play may not.
+    if (state == EngineState::GAME && loaded == loaded_index &&
+        ALLOC_COUNT != allocs) {
+      std::cerr << "Tick " << t << " allocated "
+                << ALLOC_COUNT - allocs << " times" << std::endl;
+      std::abort();
+    }
+#endif
   }
+  TELEMETRY.end(Outcome::QUIT, t);
+  latency.report();
 }
 
 void Engine::update(void) {
+  PROFILE_SCOPE("Engine::update");
   switch (state) { // Select update function according to Engine state
     case EngineState::INTRO: update_intro(); break;
     case EngineState::MENU:  update_menu(); break;
     case EngineState::GAME:  update_game(); break;
     case EngineState::QUIT:  update_quit(); break;
   }
+
+  if (state == EngineState::GAME) {
+    SPECTATOR.publish();
+  }
 }
 
 void Engine::update_intro(void) {
@@ -472,67 +541,78 @@ void Engine::update_menu(void) {
 }
 
 void Engine::update_game(void) {
-  // Process input if player is not falling
-  if (!player.fall &&
-     (current_level->get(player.x, player.y + 1).isSolid() ||
-      current_level->get(player.x, player.y + 1).id == TileID::LADDER)) {
-    if (!getKeypress()) return;
-  }
-  else { // Otherwise, pretend no keys were pressed and wait.
-    lastkey.pressed = false;
-    TCODSystem::sleepMilli(50);
-  }
+  { // Input handling
+    PROFILE_SCOPE("Engine::update_game input");
+
+    // Process input if player is not falling
+    if (!player.fall &&
+       (current_level->get(player.x, player.y + 1).isSolid() ||
+        current_level->get(player.x, player.y + 1).id == TileID::LADDER)) {
+      if (!getKeypress()) return;
+    }
+    else { // Otherwise, queue keys until landing and fall on a timer.
+      input.poll();
+      unsigned long now = TCODSystem::getElapsedMilli();
+      if (now < fall_time) return;
+      fall_time = now + FALL_DELAY;
+      lastkey.pressed = false;
+    }
 
-  if (lastkey.pressed) { // Process input
-    Tile *tile;
-    switch (lastkey.vk) {
-      default: break;
-      case TCODK_ESCAPE:
-        state = EngineState::QUIT;
-        return;
-        break;
-      case TCODK_ENTER:
-        std::cerr << "ENTER" << std::endl;
-        break;
-
-      case TCODK_LEFT:
-        tile = &current_level->get(player.x, player.y + 1);
-        if (tile->isSolid() || tile->id == TileID::LADDER) {
-          player.step = Step::LEFT;
-        }
-        break;
-      case TCODK_RIGHT:
-        tile = &current_level->get(player.x, player.y + 1);
-        if (tile->isSolid() || tile->id == TileID::LADDER) {
-          player.step = Step::RIGHT;
-        }
-        break;
-      case TCODK_UP:
-        tile = &current_level->get(player.x, player.y);
-        if (tile->id == TileID::LADDER) {
-          player.step = Step::UP;
-        }
-        break;
-      case TCODK_DOWN:
-        tile = &current_level->get(player.x, player.y + 1);
-        if (tile->id == TileID::LADDER) {
-          player.step = Step::DOWN;
-        }
-        break;
-      case TCODK_SPACE:
-        player.step = Step::NONE;
-        break;
-      case TCODK_CHAR:
-        if(lastkey.c == 'r') {
-          levelReset(); 
-        }
-        break;
+    if (lastkey.pressed) { // Process input
+      Tile *tile;
+      switch (lastkey.vk) {
+        default: break;
+        case TCODK_ESCAPE:
+          state = EngineState::QUIT;
+          return;
+          break;
+        case TCODK_ENTER:
+          std::cerr << "ENTER" << std::endl;
+          break;
+
+        case TCODK_LEFT:
+          tile = &current_level->get(player.x, player.y + 1);
+          if (tile->isSolid() || tile->id == TileID::LADDER) {
+            player.step = Step::LEFT;
+          }
+          break;
+        case TCODK_RIGHT:
+          tile = &current_level->get(player.x, player.y + 1);
+          if (tile->isSolid() || tile->id == TileID::LADDER) {
+            player.step = Step::RIGHT;
+          }
+          break;
+        case TCODK_UP:
+          tile = &current_level->get(player.x, player.y);
+          if (tile->id == TileID::LADDER) {
+            player.step = Step::UP;
+          }
+          break;
+        case TCODK_DOWN:
+          tile = &current_level->get(player.x, player.y + 1);
+          if (tile->id == TileID::LADDER) {
+            player.step = Step::DOWN;
+          }
+          break;
+        case TCODK_SPACE:
+          player.step = Step::NONE;
+          break;
+        case TCODK_CHAR:
+          if(lastkey.c == 'r') {
+            levelReset(); 
+            ++TELEMETRY.attempt.resets;
+          }
+          break;
+      }
     }
   }
 
   // Update entities and camera
   player.update();
-  for (auto &i: entities) { i.update(); }
+  {
+    PROFILE_SCOPE("Entity::update");
+    for (auto &i: entities) { i.update(); }
+  }
   moveCamera();
 
   // Increment time
@@ -544,6 +624,8 @@ void Engine::update_quit(void) {
 }
 
 void Engine::draw(void) {
+  repaint = state != drawn;
+  drawn = state;
   switch (state) { // Select draw function according to Engine state
     case EngineState::INTRO: draw_intro(); break;
     case EngineState::MENU:  draw_menu(); break;
@@ -552,79 +634,119 @@ void Engine::draw(void) {
     default: break;
   }
 
-  TCODConsole::flush();
+  {
+    PROFILE_SCOPE("TCODConsole::flush");
+    TCODConsole::flush();
+  }
+  latency.stop(TCODSystem::getElapsedMilli());
 }
 
 void Engine::draw_intro(void) {
-  // Draw :: DODECAPLEX :: Logo
-  unsigned i = WIN_W / 2 - 8, j = WIN_H / 2 - 10; // Top left corner
-  TCODConsole::root->setDefaultBackground(TCODColor::red);
-  TCODConsole::root->rect(i + 5, j + 1, 6, 4, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 4, j + 2, 8, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::yellow);
-  TCODConsole::root->rect(i + 5, j + 5, 6, 7, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 4, j + 7, 8, 4, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 6, j + 12, 4, 1, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::fuchsia);
-  TCODConsole::root->rect(i + 3, j + 2, 1, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 2, j + 3, 1, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 3, j + 4, 2, 3, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 1, j + 5, 3, 6, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::green);
-  TCODConsole::root->rect(i + 12, j + 2, 1, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 13, j + 3, 1, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 11, j + 4, 2, 3, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 12, j + 5, 3, 6, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::blue);
-  TCODConsole::root->rect(i + 2, j + 11, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 3, j + 12, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 5, j + 13, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::cyan);
-  TCODConsole::root->rect(i + 11, j + 11, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 10, j + 12, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->rect(i + 8, j + 13, 3, 2, 0, TCOD_BKGND_SET);
-  TCODConsole::root->setDefaultBackground(TCODColor::black);
-  TCODConsole::root->printEx(WIN_W / 2, WIN_H / 2 + 6,
-                             TCOD_BKGND_NONE, TCOD_CENTER,
-                             ":: DODECAPLEX ::\npresents");
+  if (!repaint) return;
+  TCODConsole::blit(intro_screen, 0, 0, WIN_W, WIN_H,
+                    TCODConsole::root, 0, 0);
 }
 
 void Engine::draw_menu(void) {
-  TCODConsole::root->clear();
-  std::string menustr(":: APPEND ::\n\n");
-  switch (menu_selection) {
-    case MenuItem::NEW:
-      menustr += "> NEW <\n\nCONTINUE\n\nQUIT"; break;
-    case MenuItem::CONTINUE:
-      menustr += "NEW\n\n> CONTINUE <\n\nQUIT"; break;
-    case MenuItem::QUIT:
-      menustr += "NEW\n\nCONTINUE\n\n> QUIT <"; break;
-    default: break;
-  }
-  TCODConsole::root->printEx(WIN_W / 2, 8,
-                             TCOD_BKGND_NONE, TCOD_CENTER,
-                             menustr.c_str());
+  if (!repaint && menu_selection == menu_drawn) return;
+  menu_drawn = menu_selection;
+  if (menu_selection > MenuItem::QUIT) return;
+  TCODConsole::blit(menu_screens[menu_selection], 0, 0, WIN_W, WIN_H,
+                    TCODConsole::root, 0, 0);
 }
 
 void Engine::draw_game(void) {
-  TCODConsole::root->printFrame(VIEW_X - 1, VIEW_Y - 1,
-                                VIEW_W + 2, VIEW_H + 2, false);
-  current_level->draw();
-  for (auto &i: entities) { i.draw(); }
-  player.draw();
+  if (repaint) { // Border, and a view that has to be put in full
+    TCODConsole::blit(frame_screen, 0, 0, WIN_W, WIN_H,
+                      TCODConsole::root, 0, 0);
+    shown.invalidate();
+    dirty = true;
+  }
+  if (!dirty) return;
+  dirty = false;
+
+  current_level->draw(view);
+  for (auto &i: entities) { i.draw(view); }
+  player.draw(view);
+  view.blit(TCODConsole::root, VIEW_X, VIEW_Y, shown);
 }
 
 void Engine::draw_quit(void) {
 }
 
+void Engine::renderScreens(void) {
+  // Screens that never change are drawn once, here, and blitted after.
+  TCODConsole *con = intro_screen = new TCODConsole(WIN_W, WIN_H);
+
+  // Draw :: DODECAPLEX :: Logo
+  unsigned i = WIN_W / 2 - 8, j = WIN_H / 2 - 10; // Top left corner
+  con->setDefaultBackground(TCODColor::red);
+  con->rect(i + 5, j + 1, 6, 4, 0, TCOD_BKGND_SET);
+  con->rect(i + 4, j + 2, 8, 2, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::yellow);
+  con->rect(i + 5, j + 5, 6, 7, 0, TCOD_BKGND_SET);
+  con->rect(i + 4, j + 7, 8, 4, 0, TCOD_BKGND_SET);
+  con->rect(i + 6, j + 12, 4, 1, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::fuchsia);
+  con->rect(i + 3, j + 2, 1, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 2, j + 3, 1, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 3, j + 4, 2, 3, 0, TCOD_BKGND_SET);
+  con->rect(i + 1, j + 5, 3, 6, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::green);
+  con->rect(i + 12, j + 2, 1, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 13, j + 3, 1, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 11, j + 4, 2, 3, 0, TCOD_BKGND_SET);
+  con->rect(i + 12, j + 5, 3, 6, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::blue);
+  con->rect(i + 2, j + 11, 3, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 3, j + 12, 3, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 5, j + 13, 3, 2, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::cyan);
+  con->rect(i + 11, j + 11, 3, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 10, j + 12, 3, 2, 0, TCOD_BKGND_SET);
+  con->rect(i + 8, j + 13, 3, 2, 0, TCOD_BKGND_SET);
+  con->setDefaultBackground(TCODColor::black);
+  con->printEx(WIN_W / 2, WIN_H / 2 + 6,
+               TCOD_BKGND_NONE, TCOD_CENTER,
+               ":: DODECAPLEX ::\npresents");
+
+  static const char *MENU_TEXT[] = { // Indexed by MenuItem
+    ":: APPEND ::\n\n> NEW <\n\nCONTINUE\n\nQUIT",
+    ":: APPEND ::\n\nNEW\n\n> CONTINUE <\n\nQUIT",
+    ":: APPEND ::\n\nNEW\n\nCONTINUE\n\n> QUIT <"
+  };
+  for (unsigned k = 0; k <= MenuItem::QUIT; ++k) {
+    con = menu_screens[k] = new TCODConsole(WIN_W, WIN_H);
+    con->printEx(WIN_W / 2, 8, TCOD_BKGND_NONE, TCOD_CENTER,
+                 "%s", MENU_TEXT[k]);
+  }
+
+  con = frame_screen = new TCODConsole(WIN_W, WIN_H);
+  con->printFrame(VIEW_X - 1, VIEW_Y - 1, VIEW_W + 2, VIEW_H + 2, false);
+}
+
 bool Engine::getKeypress(void) {
-  lastkey = TCODConsole::waitForKeypress(true);
-  return lastkey.pressed;
+  input.poll();
+  InputEvent event;
+  if (!input.pop(event)) {
+    lastkey.pressed = false;
+    return false;
+  }
+  lastkey = event.key;
+  lastkey.pressed = true;
+  latency.start(event.time);
+  return true;
 }
 
 void Engine::moveCamera(void) {
-  cam_x = player.x - VIEW_W / 2;
-  cam_y = player.y - VIEW_H / 2;
+  PROFILE_SCOPE("Engine::moveCamera");
+  unsigned x = player.x - VIEW_W / 2;
+  unsigned y = player.y - VIEW_H / 2;
+  if (x != cam_x || y != cam_y) {
+    cam_x = x;
+    cam_y = y;
+    dirty = true;
+  }
 }
 
 void Engine::save(void) {
@@ -641,25 +763,27 @@ void Engine::load(void) {
 }
 
 void Engine::levelReset(void) {
+  // Levels are parsed only when entering them. Resets copy the loaded
+  // tiles back over the live ones, so neither allocates in between.
+  if (current_level == nullptr) current_level = new Level();
+  if (loaded_index != level_index) {
+    current_level->load(levelfname[level_index]);
+    loaded_index = level_index;
+    TELEMETRY.begin(level_index, t);
+  }
+  current_level->reset();
+
   gems = 0;
   keys = 0;
-  if (current_level != nullptr) delete current_level;
-  current_level = new Level(levelfname[level_index]);
   player.x = player.init_x;
   player.y = player.init_y;
-  for (auto &i: entities) {
-    i.x = i.init_x;
-    i.y = i.init_y;
-    i.flag = 0;
-  }
-  for (unsigned j = 0; j < current_level->height; ++j) {
-    for (unsigned i = 0; i < current_level->width; ++i) {
-      Tile &tile = current_level->get(i, j);
-      if (tile.id == TileID::PLAYER_WALL) { // Remove player walls.
-        tile.id = TileID(tile.flag);
-      }
-      tile.flag = 0;
-    }
+  for (unsigned i = 0; i < ENTITY_MAX; ++i) {
+    Entity &ent = entities[i];
+    ent.x = ent.init_x;
+    ent.y = ent.init_y;
+    ent.flag = 0;
+    ent.active = i < entity_count;
+    if (ent.active && ent.id == EntityID::GEM) ++gems;
   }
   moveCamera();
 }
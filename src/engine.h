@@ -20,6 +20,11 @@ const unsigned VIEW_Y = 4;
 
 const unsigned char CHAR_WALL = 219; // ASCII solid block
 
+const unsigned FPS = 60;
+const unsigned FALL_DELAY = 50;     // Milliseconds per step while falling
+const unsigned INPUT_MAX = 16;      // Keypresses buffered between ticks
+const unsigned INPUT_COALESCE = 75; // Repeats closer than this (ms) merge
+
 enum class TileID {
   NONE = 0,
   WALL,
@@ -45,6 +50,46 @@ enum class EntityID {
   LOCK
 };
 
+// A console cell. Colors point at libtcod's named colors so that the
+// tables below can be constexpr.
+struct Glyph {
+  unsigned char c;
+  const TCODColor *fg;
+  const TCODColor *bg;
+};
+
+constexpr Glyph TILE_GLYPHS[] = { // Indexed by TileID
+  { ' ', &TCODColor::white,         &TCODColor::black }, // NONE
+  { '#', &TCODColor::white,         &TCODColor::black }, // WALL
+  { '#', &TCODColor::lighterOrange, &TCODColor::black }, // PLAYER_WALL
+  { 'H', &TCODColor::yellow,        &TCODColor::black }, // LADDER
+  { 'o', &TCODColor::pink,          &TCODColor::black }, // PILLOW
+  { 'x', &TCODColor::red,           &TCODColor::black }  // SPIKE
+};
+
+constexpr Glyph ENTITY_GLYPHS[][2] = { // Indexed by EntityID, then flag
+  { { '\0', nullptr, nullptr },
+    { '\0', nullptr, nullptr } },                                 // NONE
+  { { '@', &TCODColor::orange,      &TCODColor::black },
+    { '@', &TCODColor::orange,      &TCODColor::black } },         // PLAYER
+  { { '*', &TCODColor::cyan,        &TCODColor::black },
+    { '*', &TCODColor::cyan,        &TCODColor::black } },         // GEM
+  { { 'O', &TCODColor::darkerGreen, &TCODColor::black },
+    { 'O', &TCODColor::green,       &TCODColor::darkerGreen } },   // EXIT
+  { { 'k', &TCODColor::lightYellow, &TCODColor::black },
+    { 'k', &TCODColor::lightYellow, &TCODColor::black } },         // KEY
+  { { '#', &TCODColor::black,       &TCODColor::darkestGrey },
+    { '#', &TCODColor::black,       &TCODColor::grey } }           // LOCK
+};
+
+// The level view is rasterized here and then put on the console at once.
+struct Framebuffer {
+  Glyph cells[VIEW_W * VIEW_H];
+
+  void blit(TCODConsole *con, unsigned x, unsigned y, Framebuffer &shown);
+  void invalidate(void);
+};
+
 enum class Step {
   NONE = 0,
   LEFT, RIGHT, UP, DOWN
@@ -54,7 +99,7 @@ struct Entity {
   Entity(void);
   Entity(EntityID id, unsigned x=0, unsigned y=0);
   void update(void);
-  void draw(void);
+  void draw(Framebuffer &fb);
 
   EntityID id;
   unsigned init_x;
@@ -72,21 +117,65 @@ struct Player : public Entity {
   char fall;
 };
 
+// Tile storage is an arena: it is sized for the largest level seen so
+// far and reused by every later load and reset.
 struct Level {
   Tile *tiles;
+  Tile *initial; // Tiles as loaded, restored by reset()
   unsigned width;
   unsigned height;
   unsigned size;
+  unsigned capacity;
 
+  Level(void);
   Level(unsigned width, unsigned height);
   Level(const char *fname);
   ~Level(void);
 
-  void draw(void);
+  bool load(const char *fname);
+  void addEntity(EntityID id, unsigned x, unsigned y);
+  void reset(void);
+  void reserve(unsigned size);
+
+  void draw(Framebuffer &fb);
   void set(unsigned x, unsigned y, TileID id);
   Tile &get(unsigned x, unsigned y);
 };
 
+struct InputEvent {
+  TCOD_key_t key;
+  unsigned long time; // TCODSystem::getElapsedMilli() when polled
+};
+
+// Keypresses are drained from libtcod without blocking every tick and
+// held here until the game is ready for them, e.g. after a fall.
+struct InputQueue {
+  InputEvent events[INPUT_MAX];
+  unsigned head;
+  unsigned count;
+
+  InputQueue(void);
+  void poll(void);
+  void push(const TCOD_key_t &key, unsigned long time);
+  bool pop(InputEvent &event);
+};
+
+// Time from a keypress being polled to the first flush that shows it.
+struct InputLatency {
+  bool waiting;
+  unsigned long pending;
+  unsigned long last;
+  unsigned long min;
+  unsigned long max;
+  unsigned long total;
+  unsigned long samples;
+
+  InputLatency(void);
+  void start(unsigned long time);
+  void stop(unsigned long time);
+  void report(void);
+};
+
 enum class EngineState {
   INTRO = 0,
   MENU,
@@ -109,6 +198,19 @@ struct Engine {
   unsigned cam_x;
   unsigned cam_y;
   TCOD_key_t lastkey;
+  InputQueue input;
+  InputLatency latency;
+  unsigned long fall_time;
+
+  Framebuffer view;
+  Framebuffer shown;     // What the root console holds in the view
+  bool dirty;            // The view changed since it was last drawn
+  bool repaint;          // The whole window must be drawn this frame
+  EngineState drawn;     // State whose screen is on the root console
+  unsigned menu_drawn;
+  TCODConsole *intro_screen;
+  TCODConsole *menu_screens[MenuItem::QUIT + 1];
+  TCODConsole *frame_screen;
 
   Player player;
   Entity entities[ENTITY_MAX];
@@ -118,6 +220,7 @@ struct Engine {
 
   char levelfname[LEVEL_MAX][16];
   unsigned level_index;
+  unsigned loaded_index; // Level currently parsed into current_level
   Level *current_level;
 
   Engine(void);
@@ -136,6 +239,7 @@ struct Engine {
   void draw_menu(void);
   void draw_game(void);
   void draw_quit(void);
+  void renderScreens(void);
 
   bool getKeypress(void);
   void moveCamera(void);
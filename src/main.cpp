@@ -3,9 +3,28 @@
  * @date 2/20/2015
  * @author Tony Chiodo (http://dodecaplex.net)
  */
+#include <cstring>
 #include "engine.h"
+#include "profile.h"
+#include "spectator.h"
+#include "telemetry.h"
+
+int main(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--spectate") && i + 1 < argc) {
+      SPECTATOR.open(argv[++i]);
+    }
+    else if (!std::strcmp(argv[i], "--profile") && i + 1 < argc) {
+      PROFILER.enable(argv[++i]);
+    }
+    else if (!std::strcmp(argv[i], "--telemetry") && i + 1 < argc) {
+      TELEMETRY.open(argv[++i]);
+    }
+  }
 
-int main() {
   ENGINE.run();
+  SPECTATOR.close();
+  PROFILER.save();
+  TELEMETRY.close();
   return 0;
 }
@@ -0,0 +1,116 @@
+/*!
+ * @file profile.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include "profile.h"
+
+Profiler PROFILER;
+
+static thread_local ProfileBuffer *THREAD_BUFFER = nullptr;
+
+Profiler::Profiler(void) {
+  enabled = false;
+  path[0] = '\0';
+  buffers = nullptr;
+  threads = 0;
+}
+
+Profiler::~Profiler(void) {
+  while (buffers != nullptr) {
+    ProfileBuffer *next = buffers->next;
+    delete [] buffers->events;
+    delete buffers;
+    buffers = next;
+  }
+}
+
+void Profiler::enable(const char *path) {
+  std::strncpy(this->path, path, sizeof this->path - 1);
+  this->path[sizeof this->path - 1] = '\0';
+  buffer(); // Allocate the calling thread's buffer now, not mid-frame
+  enabled = true;
+}
+
+ProfileBuffer *Profiler::buffer(void) {
+  if (THREAD_BUFFER == nullptr) {
+    ProfileBuffer *buf = new ProfileBuffer;
+    buf->events = new ProfileEvent[PROFILE_EVENTS];
+    buf->count = 0;
+    buf->dropped = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    buf->tid = ++threads;
+    buf->next = buffers;
+    buffers = buf;
+    THREAD_BUFFER = buf;
+  }
+  return THREAD_BUFFER;
+}
+
+void Profiler::record(const char *name, uint64_t start) {
+  uint64_t end = now();
+  ProfileBuffer *buf = buffer();
+  if (buf->count == PROFILE_EVENTS) {
+    ++buf->dropped;
+    return;
+  }
+  ProfileEvent &event = buf->events[buf->count++];
+  event.name = name;
+  event.start = start;
+  event.end = end;
+}
+
+uint64_t Profiler::now(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Profiler::save(void) {
+  if (!enabled) return false;
+  enabled = false;
+
+  std::ofstream fout(path);
+  if (!fout.good()) {
+    std::cerr << "Error writing profile to " << path << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  uint64_t epoch = UINT64_MAX; // Start the trace at zero
+  for (ProfileBuffer *buf = buffers; buf != nullptr; buf = buf->next) {
+    for (unsigned i = 0; i < buf->count; ++i) {
+      if (buf->events[i].start < epoch) epoch = buf->events[i].start;
+    }
+  }
+
+  // Complete ("X") events; timestamps are in microseconds.
+  fout << "{\"traceEvents\":[";
+  bool first = true;
+  unsigned dropped = 0;
+  fout.setf(std::ios::fixed);
+  fout.precision(3);
+  for (ProfileBuffer *buf = buffers; buf != nullptr; buf = buf->next) {
+    for (unsigned i = 0; i < buf->count; ++i) {
+      ProfileEvent &event = buf->events[i];
+      fout << (first ? "\n" : ",\n")
+           << "{\"name\":\"" << event.name
+           << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buf->tid
+           << ",\"ts\":" << (event.start - epoch) / 1000.0
+           << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+      first = false;
+    }
+    dropped += buf->dropped;
+  }
+  fout << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  fout.close();
+
+  if (dropped) {
+    std::cerr << "Profile buffers filled up; " << dropped
+              << " scopes were not recorded" << std::endl;
+  }
+  return true;
+}
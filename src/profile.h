@@ -0,0 +1,66 @@
+/*!
+ * @file profile.h
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+const unsigned PROFILE_EVENTS = 1 << 20; // Per thread
+
+struct ProfileEvent {
+  const char *name;
+  uint64_t start; // Nanoseconds, std::chrono::steady_clock
+  uint64_t end;
+};
+
+struct ProfileBuffer {
+  ProfileEvent *events;
+  unsigned count;
+  unsigned dropped;
+  unsigned tid;
+  ProfileBuffer *next;
+};
+
+// Collects timed scopes into per-thread buffers and writes them out as
+// Chrome trace-event JSON (chrome://tracing, Perfetto). While disabled,
+// a scope costs a single test of `enabled`.
+struct Profiler {
+  bool enabled;
+  char path[256];
+  std::mutex mutex; // Guards buffers
+  ProfileBuffer *buffers;
+  unsigned threads;
+
+  Profiler(void);
+  ~Profiler(void);
+
+  void enable(const char *path);
+  bool save(void);
+
+  ProfileBuffer *buffer(void);
+  void record(const char *name, uint64_t start);
+  static uint64_t now(void);
+};
+
+extern Profiler PROFILER;
+
+struct ProfileScope {
+  const char *name;
+  uint64_t start;
+
+  ProfileScope(const char *name) {
+    this->name = PROFILER.enabled ? name : nullptr;
+    if (this->name) start = Profiler::now();
+  }
+  ~ProfileScope(void) {
+    if (name) PROFILER.record(name, start);
+  }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) \
+  ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
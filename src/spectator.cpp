@@ -0,0 +1,314 @@
+/*!
+ * @file spectator.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "spectator.h"
+
+Spectator SPECTATOR;
+
+static EntityState stateOf(const Entity &ent) {
+  EntityState s;
+  s.id = uint8_t(ent.id);
+  s.x = uint16_t(ent.x);
+  s.y = uint16_t(ent.y);
+  s.flag = uint8_t(ent.flag);
+  s.active = ent.active;
+  return s;
+}
+
+static const Entity &entityAt(unsigned slot) {
+  return slot ? ENGINE.entities[slot - 1] : ENGINE.player;
+}
+
+static char *putEntity(char *p, unsigned slot, const EntityState &s) {
+  p = put8(p, uint8_t(slot));
+  p = put8(p, s.id);
+  p = put16(p, s.x);
+  p = put16(p, s.y);
+  p = put8(p, s.flag);
+  p = put8(p, s.active);
+  return p;
+}
+
+bool EntityState::operator==(const EntityState &other) const {
+  return id == other.id && x == other.x && y == other.y &&
+         flag == other.flag && active == other.active;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SpectatorClient
+bool SpectatorClient::enqueue(const char *msg, unsigned len) {
+  if (tail + len > SPECTATOR_QUEUE && head > 0) { // Compact
+    std::memmove(queue, queue + head, tail - head);
+    boundary -= head;
+    tail -= head;
+    head = 0;
+  }
+  if (tail + len > SPECTATOR_QUEUE) {
+    // Overflow. Keep the message that's partially on the wire so the
+    // stream stays framed, and drop everything queued behind it.
+    tail = boundary;
+    return false;
+  }
+  std::memcpy(queue + tail, msg, len);
+  tail += len;
+  return true;
+}
+
+bool SpectatorClient::flush(void) {
+  while (head < tail) {
+    ssize_t n = send(fd, queue + head, tail - head,
+                     MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    head += n;
+    while (boundary < head) { // Step over messages that went out whole
+      const char *p = queue + boundary;
+      boundary += 4 + get32(p);
+    }
+  }
+  head = boundary = tail = 0;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Spectator
+Spectator::Spectator(void) {
+  listen_fd = -1;
+  path[0] = '\0';
+  for (auto &c: clients) {
+    c.fd = -1;
+    c.queue = nullptr;
+  }
+  tiles = nullptr;
+  capacity = 0;
+  width = 0;
+  height = 0;
+  level_index = 0;
+  msg = nullptr;
+  msg_capacity = 0;
+}
+
+Spectator::~Spectator(void) {
+  close();
+  delete [] tiles;
+  delete [] msg;
+}
+
+bool Spectator::open(const char *path) {
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof addr);
+  addr.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof addr.sun_path) {
+    std::cerr << "Spectator socket path too long: " << path << std::endl;
+    return false;
+  }
+  std::strcpy(addr.sun_path, path);
+
+  listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listen_fd < 0) {
+    std::cerr << "Error creating spectator socket" << std::endl;
+    return false;
+  }
+  unlink(path);
+  if (bind(listen_fd, (sockaddr *)&addr, sizeof addr) < 0 ||
+      listen(listen_fd, SPECTATOR_MAX) < 0) {
+    std::cerr << "Error binding spectator socket to " << path << std::endl;
+    ::close(listen_fd);
+    listen_fd = -1;
+    return false;
+  }
+  std::strcpy(this->path, path);
+
+  // Allocate every queue up front so that publishing never allocates.
+  for (auto &c: clients) {
+    c.queue = new char[SPECTATOR_QUEUE];
+  }
+  return true;
+}
+
+void Spectator::close(void) {
+  if (listen_fd < 0) return;
+  for (auto &c: clients) {
+    if (c.fd >= 0) ::close(c.fd);
+    c.fd = -1;
+    delete [] c.queue;
+    c.queue = nullptr;
+  }
+  ::close(listen_fd);
+  listen_fd = -1;
+  unlink(path);
+}
+
+void Spectator::publish(void) {
+  if (listen_fd < 0) return;
+  accept();
+
+  Level *level = ENGINE.current_level;
+  unsigned len = 0;
+  if (level->width != width || level->height != height ||
+      ENGINE.level_index != level_index) {
+    snapshot(); // New level; everybody starts over from a keyframe
+    for (auto &c: clients) { c.keyframe = true; }
+  }
+  else {
+    len = buildDelta();
+  }
+
+  if (len) {
+    for (auto &c: clients) {
+      if (c.fd < 0 || c.keyframe) continue;
+      if (!c.enqueue(msg, len)) {
+        c.keyframe = true;
+      }
+    }
+  }
+
+  // The shadow state is current now, so a keyframe built from it
+  // follows on from anything already queued.
+  unsigned keylen = 0;
+  for (auto &c: clients) {
+    if (c.fd < 0 || !c.keyframe) continue;
+    if (!keylen) keylen = buildKeyframe();
+    if (c.enqueue(msg, keylen)) {
+      c.keyframe = false;
+    }
+  }
+
+  for (auto &c: clients) {
+    if (c.fd >= 0 && !c.flush()) {
+      std::cerr << "Spectator disconnected" << std::endl;
+      ::close(c.fd);
+      c.fd = -1;
+    }
+  }
+}
+
+void Spectator::accept(void) {
+  int fd;
+  while ((fd = ::accept4(listen_fd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+    SpectatorClient *slot = nullptr;
+    for (auto &c: clients) {
+      if (c.fd < 0) {
+        slot = &c;
+        break;
+      }
+    }
+    if (slot == nullptr) { // Full up
+      ::close(fd);
+      continue;
+    }
+    slot->fd = fd;
+    slot->head = slot->boundary = slot->tail = 0;
+    slot->keyframe = true;
+    std::cerr << "Spectator connected" << std::endl;
+  }
+}
+
+void Spectator::snapshot(void) {
+  Level *level = ENGINE.current_level;
+  if (level->size > capacity) {
+    delete [] tiles;
+    capacity = level->size;
+    tiles = new uint8_t[capacity];
+  }
+  width = level->width;
+  height = level->height;
+  level_index = ENGINE.level_index;
+  for (unsigned i = 0; i < level->size; ++i) {
+    tiles[i] = uint8_t(level->tiles[i].id);
+  }
+  for (unsigned i = 0; i <= ENTITY_MAX; ++i) {
+    entities[i] = stateOf(entityAt(i));
+  }
+  cam_x = ENGINE.cam_x;
+  cam_y = ENGINE.cam_y;
+
+  // Big enough for a keyframe or a delta that touches every tile.
+  reserve(32 + level->size * TILE_RECORD_SIZE +
+          (ENTITY_MAX + 1) * ENTITY_RECORD_SIZE);
+}
+
+unsigned Spectator::buildKeyframe(void) {
+  char *p = msg + 4;
+  p = put8(p, uint8_t(MessageType::KEYFRAME));
+  p = put32(p, uint32_t(ENGINE.t));
+  p = put8(p, uint8_t(level_index));
+  p = put8(p, VIEW_W);
+  p = put8(p, VIEW_H);
+  p = put16(p, uint16_t(width));
+  p = put16(p, uint16_t(height));
+  p = put32(p, cam_x);
+  p = put32(p, cam_y);
+  std::memcpy(p, tiles, width * height);
+  p += width * height;
+  p = put8(p, ENTITY_MAX + 1);
+  for (unsigned i = 0; i <= ENTITY_MAX; ++i) {
+    p = putEntity(p, i, entities[i]);
+  }
+
+  unsigned len = p - msg;
+  put32(msg, len - 4);
+  return len;
+}
+
+unsigned Spectator::buildDelta(void) {
+  Level *level = ENGINE.current_level;
+  bool moved = ENGINE.cam_x != cam_x || ENGINE.cam_y != cam_y;
+  cam_x = ENGINE.cam_x;
+  cam_y = ENGINE.cam_y;
+
+  char *p = msg + 4;
+  p = put8(p, uint8_t(MessageType::DELTA));
+  p = put32(p, uint32_t(ENGINE.t));
+  p = put32(p, cam_x);
+  p = put32(p, cam_y);
+
+  char *count = p;
+  p += 4;
+  unsigned n = 0;
+  for (unsigned i = 0; i < level->size; ++i) {
+    uint8_t id = uint8_t(level->tiles[i].id);
+    if (id != tiles[i]) {
+      tiles[i] = id;
+      p = put32(p, i);
+      p = put8(p, id);
+      ++n;
+    }
+  }
+  put32(count, n);
+
+  count = p++;
+  unsigned m = 0;
+  for (unsigned i = 0; i <= ENTITY_MAX; ++i) {
+    EntityState s = stateOf(entityAt(i));
+    if (!(s == entities[i])) {
+      entities[i] = s;
+      p = putEntity(p, i, s);
+      ++m;
+    }
+  }
+  put8(count, uint8_t(m));
+
+  if (!(n || m || moved)) return 0; // Nothing to say
+  unsigned len = p - msg;
+  put32(msg, len - 4);
+  return len;
+}
+
+void Spectator::reserve(unsigned size) {
+  if (size <= msg_capacity) return;
+  delete [] msg;
+  msg_capacity = size;
+  msg = new char[msg_capacity];
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file spectator.h
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#pragma once
+
+#include "engine.h"
+#include "stream.h"
+
+const unsigned SPECTATOR_MAX = 8;
+const unsigned SPECTATOR_QUEUE = 1 << 18; // Bytes buffered per client
+
+struct EntityState {
+  uint8_t id;
+  uint16_t x;
+  uint16_t y;
+  uint8_t flag;
+  uint8_t active;
+
+  bool operator==(const EntityState &other) const;
+};
+
+struct SpectatorClient {
+  int fd;
+  char *queue;
+  unsigned head;     // First unsent byte
+  unsigned boundary; // End of the message being sent (>= head)
+  unsigned tail;     // End of queued data
+  bool keyframe;     // Waiting for a keyframe; deltas are skipped
+
+  bool enqueue(const char *msg, unsigned len);
+  bool flush(void);
+};
+
+// Publishes the game to local observers over a Unix domain socket.
+// Nothing here may block the game loop: sockets are non-blocking and
+// each client has a bounded queue that falls back to a keyframe when
+// the client can't keep up.
+struct Spectator {
+  int listen_fd;
+  char path[108];
+  SpectatorClient clients[SPECTATOR_MAX];
+
+  // Last published state, diffed against the engine every tick
+  uint8_t *tiles;
+  unsigned capacity;
+  unsigned width;
+  unsigned height;
+  unsigned level_index;
+  uint32_t cam_x;
+  uint32_t cam_y;
+  EntityState entities[ENTITY_MAX + 1];
+
+  char *msg; // Scratch space for building one message
+  unsigned msg_capacity;
+
+  Spectator(void);
+  ~Spectator(void);
+
+  bool open(const char *path);
+  void close(void);
+  void publish(void);
+
+  void accept(void);
+  void snapshot(void);
+  unsigned buildKeyframe(void);
+  unsigned buildDelta(void);
+  void reserve(unsigned size);
+};
+
+extern Spectator SPECTATOR;
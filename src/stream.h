@@ -0,0 +1,71 @@
+/*!
+ * @file stream.h
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ *
+ * Wire format shared by the spectator server and tools/spectate.cpp.
+ *
+ * Every message is a little-endian u32 length followed by that many bytes.
+ * The first byte is a MessageType:
+ *
+ *   KEYFRAME: u32 tick, u8 level, u8 view_w, u8 view_h,
+ *             u16 width, u16 height, u32 cam_x, u32 cam_y,
+ *             u8 tiles[width * height], u8 n, EntityRecord[n]
+ *   DELTA:    u32 tick, u32 cam_x, u32 cam_y,
+ *             u32 n, TileRecord[n], u8 m, EntityRecord[m]
+ *
+ *   TileRecord:   u32 index, u8 id
+ *   EntityRecord: u8 slot, u8 id, u16 x, u16 y, u8 flag, u8 active
+ *
+ * Entity slot 0 is the player; slot i + 1 is Engine::entities[i].
+ */
+#pragma once
+
+#include <cstdint>
+
+enum class MessageType : uint8_t {
+  NONE = 0,
+  KEYFRAME,
+  DELTA
+};
+
+const unsigned TILE_RECORD_SIZE = 5;
+const unsigned ENTITY_RECORD_SIZE = 8;
+
+inline char *put8(char *p, uint8_t v) {
+  *p++ = char(v);
+  return p;
+}
+
+inline char *put16(char *p, uint16_t v) {
+  *p++ = char(v);
+  *p++ = char(v >> 8);
+  return p;
+}
+
+inline char *put32(char *p, uint32_t v) {
+  *p++ = char(v);
+  *p++ = char(v >> 8);
+  *p++ = char(v >> 16);
+  *p++ = char(v >> 24);
+  return p;
+}
+
+inline uint8_t get8(const char *&p) {
+  return uint8_t(*p++);
+}
+
+inline uint16_t get16(const char *&p) {
+  uint16_t v = uint8_t(p[0]) | uint8_t(p[1]) << 8;
+  p += 2;
+  return v;
+}
+
+inline uint32_t get32(const char *&p) {
+  uint32_t v = uint32_t(uint8_t(p[0])) |
+               uint32_t(uint8_t(p[1])) << 8 |
+               uint32_t(uint8_t(p[2])) << 16 |
+               uint32_t(uint8_t(p[3])) << 24;
+  p += 4;
+  return v;
+}
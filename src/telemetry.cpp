@@ -0,0 +1,116 @@
+/*!
+ * @file telemetry.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ */
+#include <iostream>
+#include "telemetry.h"
+
+Telemetry TELEMETRY;
+
+////////////////////////////////////////////////////////////////////////////////
+// TelemetryBatch
+void TelemetryBatch::write(FILE *fout) {
+  uint32_t header[2] = { TELEMETRY_MAGIC, count };
+  std::fwrite(header, sizeof header, 1, fout);
+  std::fwrite(level, sizeof *level, count, fout);
+  std::fwrite(ticks, sizeof *ticks, count, fout);
+  std::fwrite(resets, sizeof *resets, count, fout);
+  std::fwrite(walls, sizeof *walls, count, fout);
+  std::fwrite(gems, sizeof *gems, count, fout);
+  std::fwrite(keys, sizeof *keys, count, fout);
+  std::fwrite(outcome, sizeof *outcome, count, fout);
+  std::fflush(fout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Telemetry
+Telemetry::Telemetry(void) {
+  attempt.active = false;
+  fout = nullptr;
+  batches[0].count = 0;
+  batches[1].count = 0;
+  filling = &batches[0];
+  pending = nullptr;
+  stop = false;
+}
+
+Telemetry::~Telemetry(void) {
+  close();
+}
+
+bool Telemetry::open(const char *path) {
+  fout = std::fopen(path, "ab");
+  if (fout == nullptr) {
+    std::cerr << "Error opening telemetry log " << path << std::endl;
+    return false;
+  }
+  stop = false;
+  writer = std::thread(&Telemetry::run, this);
+  return true;
+}
+
+void Telemetry::close(void) {
+  if (fout == nullptr) return;
+  if (filling->count) handoff();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cond.notify_all();
+  writer.join();
+  std::fclose(fout);
+  fout = nullptr;
+}
+
+void Telemetry::begin(unsigned level, unsigned long t) {
+  attempt.active = true;
+  attempt.level = level;
+  attempt.start = t;
+  attempt.resets = 0;
+  attempt.walls = 0;
+  attempt.gems = 0;
+  attempt.keys = 0;
+}
+
+void Telemetry::end(Outcome outcome, unsigned long t) {
+  if (!attempt.active) return;
+  attempt.active = false;
+  if (fout == nullptr) return;
+
+  unsigned i = filling->count++;
+  filling->level[i] = uint8_t(attempt.level);
+  filling->ticks[i] = uint32_t(t - attempt.start);
+  filling->resets[i] = uint16_t(attempt.resets);
+  filling->walls[i] = uint32_t(attempt.walls);
+  filling->gems[i] = uint16_t(attempt.gems);
+  filling->keys[i] = uint16_t(attempt.keys);
+  filling->outcome[i] = uint8_t(outcome);
+  if (filling->count == TELEMETRY_BATCH) handoff();
+}
+
+void Telemetry::handoff(void) {
+  std::unique_lock<std::mutex> lock(mutex);
+  // Only waits if a whole batch filled before the last one was written.
+  cond.wait(lock, [this] { return pending == nullptr; });
+  pending = filling;
+  filling = filling == &batches[0] ? &batches[1] : &batches[0];
+  filling->count = 0;
+  lock.unlock();
+  cond.notify_all();
+}
+
+void Telemetry::run(void) {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    cond.wait(lock, [this] { return pending != nullptr || stop; });
+    if (pending == nullptr) return; // Stopped with nothing left to write
+
+    TelemetryBatch *batch = pending;
+    lock.unlock();
+    batch->write(fout);
+    lock.lock();
+    pending = nullptr;
+    cond.notify_all();
+  }
+}
@@ -0,0 +1,83 @@
+/*!
+ * @file telemetry.h
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ *
+ * Per-attempt gameplay telemetry. An attempt runs from entering a level
+ * until it is completed or the game quits; resets don't end it.
+ *
+ * The log is a sequence of columnar blocks in host byte order:
+ *
+ *   u32 magic, u32 n,
+ *   u8 level[n], u32 ticks[n], u16 resets[n], u32 walls[n],
+ *   u16 gems[n], u16 keys[n], u8 outcome[n]
+ *
+ * tools/telemetry.cpp aggregates it.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+const uint32_t TELEMETRY_MAGIC = 0x4C455441; // "ATEL"
+const unsigned TELEMETRY_BATCH = 256;        // Records per block
+
+enum class Outcome : uint8_t {
+  NONE = 0,
+  COMPLETE,
+  QUIT
+};
+
+struct Attempt {
+  bool active;
+  unsigned level;
+  unsigned long start; // Engine::t on entry
+  unsigned resets;
+  unsigned walls;
+  unsigned gems;
+  unsigned keys;
+};
+
+struct TelemetryBatch {
+  unsigned count;
+  uint8_t level[TELEMETRY_BATCH];
+  uint32_t ticks[TELEMETRY_BATCH];
+  uint16_t resets[TELEMETRY_BATCH];
+  uint32_t walls[TELEMETRY_BATCH];
+  uint16_t gems[TELEMETRY_BATCH];
+  uint16_t keys[TELEMETRY_BATCH];
+  uint8_t outcome[TELEMETRY_BATCH];
+
+  void write(FILE *fout);
+};
+
+// The game thread fills one batch while a writer thread saves the other.
+struct Telemetry {
+  Attempt attempt;
+
+  FILE *fout;
+  TelemetryBatch batches[2];
+  TelemetryBatch *filling;
+  TelemetryBatch *pending; // Handed to the writer; null once written
+  std::thread writer;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool stop;
+
+  Telemetry(void);
+  ~Telemetry(void);
+
+  bool open(const char *path);
+  void close(void);
+
+  void begin(unsigned level, unsigned long t);
+  void end(Outcome outcome, unsigned long t);
+
+  void handoff(void);
+  void run(void);
+};
+
+extern Telemetry TELEMETRY;
@@ -0,0 +1,197 @@
+/*!
+ * @file spectate.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ *
+ * Companion viewer for `append --spectate <socket>`. Rebuilds the game
+ * view from the stream and draws it to the terminal with ANSI escapes.
+ *
+ *   g++ -std=c++11 -o spectate tools/spectate.cpp
+ *   ./spectate /tmp/append.sock
+ */
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../src/stream.h"
+
+const unsigned SLOT_MAX = 256;
+
+struct EntityView {
+  uint8_t id;
+  unsigned x;
+  unsigned y;
+  uint8_t flag;
+  bool active;
+};
+
+struct View {
+  unsigned tick;
+  unsigned level;
+  unsigned view_w;
+  unsigned view_h;
+  unsigned width;
+  unsigned height;
+  unsigned cam_x;
+  unsigned cam_y;
+  std::vector<uint8_t> tiles;
+  EntityView entities[SLOT_MAX];
+  bool ready;
+
+  void keyframe(const char *p);
+  void delta(const char *p);
+  void readEntities(const char *&p, unsigned n);
+  void draw(void);
+};
+
+// Mirrors the glyphs and colors of Level::draw and Entity::draw,
+// indexed by TileID and EntityID respectively.
+static const char *TILE_GLYPHS[] = {
+  " ",
+  "\x1b[37m#",
+  "\x1b[38;5;216m#",
+  "\x1b[93mH",
+  "\x1b[95mo",
+  "\x1b[91mx"
+};
+
+static const char *entityGlyph(const EntityView &ent) {
+  switch (ent.id) {
+    case 1: return "\x1b[38;5;208m@";
+    case 2: return "\x1b[96m*";
+    case 3: return ent.flag ? "\x1b[92;42mO" : "\x1b[32mO";
+    case 4: return "\x1b[93mk";
+    case 5: return ent.flag ? "\x1b[30;47m#" : "\x1b[30;100m#";
+    default: return nullptr;
+  }
+}
+
+void View::keyframe(const char *p) {
+  tick = get32(p);
+  level = get8(p);
+  view_w = get8(p);
+  view_h = get8(p);
+  width = get16(p);
+  height = get16(p);
+  cam_x = get32(p);
+  cam_y = get32(p);
+  tiles.assign(p, p + width * height);
+  p += width * height;
+  std::memset(entities, 0, sizeof entities);
+  readEntities(p, get8(p));
+  ready = true;
+}
+
+void View::delta(const char *p) {
+  tick = get32(p);
+  cam_x = get32(p);
+  cam_y = get32(p);
+  unsigned n = get32(p);
+  for (unsigned i = 0; i < n; ++i) {
+    unsigned index = get32(p);
+    uint8_t id = get8(p);
+    if (index < tiles.size()) tiles[index] = id;
+  }
+  readEntities(p, get8(p));
+}
+
+void View::readEntities(const char *&p, unsigned n) {
+  for (unsigned i = 0; i < n; ++i) {
+    EntityView &ent = entities[get8(p)];
+    ent.id = get8(p);
+    ent.x = get16(p);
+    ent.y = get16(p);
+    ent.flag = get8(p);
+    ent.active = get8(p);
+  }
+}
+
+void View::draw(void) {
+  // Compose the view, then place entities at their wrapped positions.
+  std::vector<const char *> cells(view_w * view_h);
+  for (unsigned j = 0; j < view_h; ++j) {
+    unsigned yy = (cam_y + j) % height;
+    for (unsigned i = 0; i < view_w; ++i) {
+      unsigned xx = (cam_x + i) % width;
+      uint8_t id = tiles[xx + width * yy];
+      cells[i + view_w * j] = id < 6 ? TILE_GLYPHS[id] : "?";
+    }
+  }
+  for (unsigned k = 1; k <= SLOT_MAX; ++k) { // Player (slot 0) drawn last
+    EntityView &ent = entities[k % SLOT_MAX];
+    const char *glyph = entityGlyph(ent);
+    if (!ent.active || glyph == nullptr) continue;
+    unsigned i0 = (ent.x - cam_x) % width;
+    unsigned j0 = (ent.y - cam_y) % height;
+    for (unsigned j = j0; j < view_h; j += height) {
+      for (unsigned i = i0; i < view_w; i += width) {
+        cells[i + view_w * j] = glyph;
+      }
+    }
+  }
+
+  std::string out("\x1b[H");
+  for (unsigned j = 0; j < view_h; ++j) {
+    for (unsigned i = 0; i < view_w; ++i) {
+      out += cells[i + view_w * j];
+      out += "\x1b[0m";
+    }
+    out += '\n';
+  }
+  out += "level " + std::to_string(level) +
+         "  tick " + std::to_string(tick) + "\x1b[K\n";
+  std::cout << out << std::flush;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <socket>" << std::endl;
+    return 1;
+  }
+
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof addr);
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, argv[1], sizeof addr.sun_path - 1);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || connect(fd, (sockaddr *)&addr, sizeof addr) < 0) {
+    std::cerr << "Error connecting to " << argv[1] << std::endl;
+    return 1;
+  }
+
+  View view;
+  view.ready = false;
+  std::vector<char> buf;
+  char chunk[1 << 16];
+  std::cout << "\x1b[2J";
+  while (true) {
+    ssize_t n = recv(fd, chunk, sizeof chunk, 0);
+    if (n <= 0) break;
+    buf.insert(buf.end(), chunk, chunk + n);
+
+    // Apply every complete message, but only redraw once per read.
+    size_t off = 0;
+    while (buf.size() - off >= 4) {
+      const char *p = buf.data() + off;
+      uint32_t len = get32(p);
+      if (buf.size() - off - 4 < len) break;
+      switch (MessageType(get8(p))) {
+        case MessageType::KEYFRAME: view.keyframe(p); break;
+        case MessageType::DELTA:
+          if (view.ready) view.delta(p);
+          break;
+        default: break;
+      }
+      off += 4 + len;
+    }
+    buf.erase(buf.begin(), buf.begin() + off);
+    if (view.ready) view.draw();
+  }
+
+  close(fd);
+  std::cout << "\x1b[0m" << std::endl;
+  return 0;
+}
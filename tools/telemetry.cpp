@@ -0,0 +1,141 @@
+/*!
+ * @file telemetry.cpp
+ * @date 10/19/2026
+ * @author Tony Chiodo (http://dodecaplex.net)
+ *
+ * Aggregates logs written by `append --telemetry <file>`: per level,
+ * attempt counts, averages, and the distribution of ticks taken by
+ * completed attempts.
+ *
+ *   g++ -std=c++11 -O2 -o telemetry tools/telemetry.cpp
+ *   ./telemetry telemetry.dat [more.dat ...]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../src/telemetry.h"
+
+const unsigned LEVELS = 256;
+
+struct LevelStats {
+  unsigned long attempts;
+  unsigned long completed;
+  unsigned long resets;
+  unsigned long walls;
+  unsigned long gems;
+  unsigned long keys;
+  std::vector<uint32_t> ticks; // Completed attempts only
+};
+
+// A column of n values of type T; they may be unaligned in the buffer.
+template <typename T>
+struct Column {
+  const char *data;
+
+  Column(const char *&p, unsigned n) {
+    data = p;
+    p += n * sizeof(T);
+  }
+  T operator[](unsigned i) const {
+    T v;
+    std::memcpy(&v, data + i * sizeof(T), sizeof v);
+    return v;
+  }
+};
+
+static bool aggregate(const char *fname, LevelStats *stats) {
+  FILE *fin = std::fopen(fname, "rb");
+  if (fin == nullptr) {
+    std::fprintf(stderr, "Error opening %s\n", fname);
+    return false;
+  }
+  std::fseek(fin, 0, SEEK_END);
+  long size = std::ftell(fin);
+  std::fseek(fin, 0, SEEK_SET);
+  std::vector<char> buf(size);
+  if (size && std::fread(buf.data(), size, 1, fin) != 1) {
+    std::fprintf(stderr, "Error reading %s\n", fname);
+    std::fclose(fin);
+    return false;
+  }
+  std::fclose(fin);
+
+  // One record is 16 bytes spread over the columns.
+  const unsigned RECORD = 1 + 4 + 2 + 4 + 2 + 2 + 1;
+  const char *p = buf.data();
+  const char *end = p + size;
+  while (end - p >= 8) {
+    uint32_t header[2];
+    std::memcpy(header, p, sizeof header);
+    if (header[0] != TELEMETRY_MAGIC ||
+        unsigned(end - p - 8) < header[1] * RECORD) {
+      std::fprintf(stderr, "%s: truncated or corrupt block\n", fname);
+      return false;
+    }
+    unsigned n = header[1];
+    p += 8;
+
+    Column<uint8_t> level(p, n);
+    Column<uint32_t> ticks(p, n);
+    Column<uint16_t> resets(p, n);
+    Column<uint32_t> walls(p, n);
+    Column<uint16_t> gems(p, n);
+    Column<uint16_t> keys(p, n);
+    Column<uint8_t> outcome(p, n);
+    for (unsigned i = 0; i < n; ++i) {
+      LevelStats &s = stats[level[i]];
+      ++s.attempts;
+      s.resets += resets[i];
+      s.walls += walls[i];
+      s.gems += gems[i];
+      s.keys += keys[i];
+      if (Outcome(outcome[i]) == Outcome::COMPLETE) {
+        ++s.completed;
+        s.ticks.push_back(ticks[i]);
+      }
+    }
+  }
+  return true;
+}
+
+static uint32_t percentile(std::vector<uint32_t> &v, unsigned pct) {
+  auto nth = v.begin() + (v.size() - 1) * pct / 100;
+  std::nth_element(v.begin(), nth, v.end());
+  return *nth;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <log> [log ...]\n", argv[0]);
+    return 1;
+  }
+
+  static LevelStats stats[LEVELS];
+  for (int i = 1; i < argc; ++i) {
+    if (!aggregate(argv[i], stats)) return 1;
+  }
+
+  std::printf("%5s %9s %9s %7s %7s %6s %6s | %7s %7s %7s %7s %7s %7s\n",
+              "level", "attempts", "complete", "resets", "walls",
+              "gems", "keys", "min", "p10", "p50", "p90", "p99", "max");
+  for (unsigned l = 0; l < LEVELS; ++l) {
+    LevelStats &s = stats[l];
+    if (!s.attempts) continue;
+    double n = double(s.attempts);
+    std::printf("%5u %9lu %9lu %7.2f %7.1f %6.2f %6.2f |",
+                l, s.attempts, s.completed, s.resets / n, s.walls / n,
+                s.gems / n, s.keys / n);
+    if (s.ticks.empty()) {
+      std::printf("\n");
+      continue;
+    }
+    // Ticks taken by completed attempts
+    std::printf(" %7u %7u %7u %7u %7u %7u\n",
+                *std::min_element(s.ticks.begin(), s.ticks.end()),
+                percentile(s.ticks, 10), percentile(s.ticks, 50),
+                percentile(s.ticks, 90), percentile(s.ticks, 99),
+                *std::max_element(s.ticks.begin(), s.ticks.end()));
+  }
+  return 0;
+}